@@ -19,6 +19,7 @@
 #define __OREN_NC_BUFFER_H__
 
 #include "oren-nctypes.h"
+#include "oren-byteorder.h"
 
 G_BEGIN_DECLS
 
@@ -112,6 +113,138 @@ void oren_ncbuffer_write_u32 (OrenNCBuffer *self, guint32 val);
 
 void oren_ncbuffer_write_u64 (OrenNCBuffer *self, guint64 val);
 
+/*
+ * Unchecked read and write cursors.
+ *
+ * oren_ncbuffer_read_u8(), oren_ncbuffer_write_u8() and friends check the
+ * buffer lock and bounds on every field. Header parsers and builders can
+ * instead validate a whole fixed-size header once with
+ * oren_ncbuffer_cursor_init() or oren_ncbuffer_write_cursor_init(),
+ * access the fields straight in memory, then consume them with the
+ * matching commit function. Fields use network byte order, like
+ * oren_ncbuffer_read_u16() and oren_ncbuffer_write_u16().
+ */
+typedef struct _OrenNCBufferCursor OrenNCBufferCursor;
+typedef struct _OrenNCBufferWriteCursor OrenNCBufferWriteCursor;
+
+struct _OrenNCBufferCursor {
+    const guint8 *start;
+    const guint8 *ptr;
+    const guint8 *end;
+};
+
+struct _OrenNCBufferWriteCursor {
+    guint8 *start;
+    guint8 *ptr;
+    guint8 *end;
+};
+
+G_INLINE_FUNC gboolean oren_ncbuffer_cursor_init (OrenNCBufferCursor *cursor,
+                                                  OrenNCBuffer *self,
+                                                  gsize length)
+{
+    if (oren_ncbuffer_is_locked (self, OREN_NCBUFFER_LOCK_READ))
+        return FALSE;
+    if (oren_ncbuffer_unread_length (self) < length)
+        return FALSE;
+
+    cursor->start = (const guint8*) oren_ncbuffer_read_ptr (self);
+    cursor->ptr = cursor->start;
+    cursor->end = cursor->start + length;
+    return TRUE;
+}
+
+G_INLINE_FUNC void oren_ncbuffer_cursor_commit (OrenNCBufferCursor *cursor,
+                                                OrenNCBuffer *self)
+{
+    oren_ncbuffer_read_adv (self, cursor->ptr - cursor->start);
+}
+
+G_INLINE_FUNC gsize oren_ncbuffer_cursor_remain (OrenNCBufferCursor *cursor)
+{
+    return cursor->end - cursor->ptr;
+}
+
+G_INLINE_FUNC guint8 oren_ncbuffer_cursor_u8 (OrenNCBufferCursor *cursor)
+{
+    return *cursor->ptr++;
+}
+
+G_INLINE_FUNC guint16 oren_ncbuffer_cursor_u16 (OrenNCBufferCursor *cursor)
+{
+    guint16 val = oren_read_be16 (cursor->ptr);
+
+    cursor->ptr += 2;
+    return val;
+}
+
+G_INLINE_FUNC guint32 oren_ncbuffer_cursor_u32 (OrenNCBufferCursor *cursor)
+{
+    guint32 val = oren_read_be32 (cursor->ptr);
+
+    cursor->ptr += 4;
+    return val;
+}
+
+G_INLINE_FUNC guint64 oren_ncbuffer_cursor_u64 (OrenNCBufferCursor *cursor)
+{
+    guint64 val = oren_read_be64 (cursor->ptr);
+
+    cursor->ptr += 8;
+    return val;
+}
+
+G_INLINE_FUNC gboolean oren_ncbuffer_write_cursor_init (OrenNCBufferWriteCursor *cursor,
+                                                        OrenNCBuffer *self,
+                                                        gsize length)
+{
+    if (oren_ncbuffer_is_locked (self, OREN_NCBUFFER_LOCK_WRITE))
+        return FALSE;
+
+    cursor->start = (guint8*) oren_ncbuffer_write_ptr (self, length);
+    cursor->ptr = cursor->start;
+    cursor->end = cursor->start + length;
+    return TRUE;
+}
+
+G_INLINE_FUNC void oren_ncbuffer_write_cursor_commit (OrenNCBufferWriteCursor *cursor,
+                                                      OrenNCBuffer *self)
+{
+    oren_ncbuffer_write_adv (self, cursor->ptr - cursor->start);
+}
+
+G_INLINE_FUNC gsize oren_ncbuffer_write_cursor_remain (OrenNCBufferWriteCursor *cursor)
+{
+    return cursor->end - cursor->ptr;
+}
+
+G_INLINE_FUNC void oren_ncbuffer_write_cursor_u8 (OrenNCBufferWriteCursor *cursor,
+                                                  guint8 val)
+{
+    *cursor->ptr++ = val;
+}
+
+G_INLINE_FUNC void oren_ncbuffer_write_cursor_u16 (OrenNCBufferWriteCursor *cursor,
+                                                   guint16 val)
+{
+    oren_write_be16 (cursor->ptr, val);
+    cursor->ptr += 2;
+}
+
+G_INLINE_FUNC void oren_ncbuffer_write_cursor_u32 (OrenNCBufferWriteCursor *cursor,
+                                                   guint32 val)
+{
+    oren_write_be32 (cursor->ptr, val);
+    cursor->ptr += 4;
+}
+
+G_INLINE_FUNC void oren_ncbuffer_write_cursor_u64 (OrenNCBufferWriteCursor *cursor,
+                                                   guint64 val)
+{
+    oren_write_be64 (cursor->ptr, val);
+    cursor->ptr += 8;
+}
+
 G_END_DECLS
 
 #endif /* __OREN_NC_BUFFER_H__ */
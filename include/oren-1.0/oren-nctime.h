@@ -40,6 +40,94 @@ G_END_DECLS
 
 #else
 # include <sys/time.h>
+# include <time.h>
 #endif
 
+G_BEGIN_DECLS
+
+/*
+ * Monotonic clock.
+ *
+ * gettimeofday() follows the wall clock and jumps when it is stepped, so
+ * intervals such as RTTs and timeouts should be measured with
+ * oren_nctime_monotonic() instead. Values are nanoseconds from an
+ * unspecified origin and are only meaningful relative to each other.
+ */
+#define OREN_NCTIME_USEC G_GINT64_CONSTANT (1000)
+#define OREN_NCTIME_MSEC G_GINT64_CONSTANT (1000000)
+#define OREN_NCTIME_SEC  G_GINT64_CONSTANT (1000000000)
+
+#ifdef G_OS_WIN32
+G_INLINE_FUNC gint64 oren_nctime_monotonic (void)
+{
+    LARGE_INTEGER freq;
+    LARGE_INTEGER count;
+
+    /* The frequency is fixed at boot and cheap to query. */
+    QueryPerformanceFrequency (&freq);
+    QueryPerformanceCounter (&count);
+
+    /* Split to keep count * 10^9 from overflowing. */
+    return (count.QuadPart / freq.QuadPart) * OREN_NCTIME_SEC +
+           (count.QuadPart % freq.QuadPart) * OREN_NCTIME_SEC / freq.QuadPart;
+}
+#elif defined (CLOCK_MONOTONIC)
+G_INLINE_FUNC gint64 oren_nctime_monotonic (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (gint64) ts.tv_sec * OREN_NCTIME_SEC + ts.tv_nsec;
+}
+#else
+/* clock_gettime() is hidden without POSIX feature-test macros. */
+G_INLINE_FUNC gint64 oren_nctime_monotonic (void)
+{
+    return g_get_monotonic_time () * OREN_NCTIME_USEC;
+}
+#endif
+
+G_INLINE_FUNC void oren_nctime_to_timeval (gint64 ns,
+                                           struct timeval *tv)
+{
+    gint64 sec = ns / OREN_NCTIME_SEC;
+    gint64 rem = ns % OREN_NCTIME_SEC;
+
+    /* Floor toward negative infinity to keep 0 <= tv_usec < 10^6,
+     * as timeradd() and timersub() expect. */
+    if (rem < 0) {
+        rem += OREN_NCTIME_SEC;
+        sec -= 1;
+    }
+    tv->tv_sec = (long) sec;
+    tv->tv_usec = (long) (rem / OREN_NCTIME_USEC);
+}
+
+G_INLINE_FUNC gint64 oren_nctime_from_timeval (const struct timeval *tv)
+{
+    return (gint64) tv->tv_sec * OREN_NCTIME_SEC +
+           (gint64) tv->tv_usec * OREN_NCTIME_USEC;
+}
+
+/*
+ * Cached clock. A loop refreshes it once per iteration with
+ * oren_ncclock_update() and its callbacks read oren_ncclock_now(),
+ * so one iteration costs a single clock read.
+ */
+typedef struct _OrenNCClock OrenNCClock;
+
+struct _OrenNCClock {
+    gint64 now;
+};
+
+G_INLINE_FUNC gint64 oren_ncclock_update (OrenNCClock *self)
+{
+    self->now = oren_nctime_monotonic ();
+    return self->now;
+}
+
+#define oren_ncclock_now(_clock) ((_clock)->now)
+
+G_END_DECLS
+
 #endif /* __OREN_NC_TIME_H__ */